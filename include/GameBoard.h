@@ -6,6 +6,10 @@
 #include <random>
 #include "tile_utils.h"
 
+namespace azool {
+  struct BoardSnapshot;
+}
+
 class GameBoard {
 public:
   struct Factory {
@@ -15,7 +19,17 @@ public:
     int tileCounts[azool::NUMCOLORS];
   };  // struct Factory
 
+  // the part of the board a move can change; the bag is only touched
+  // between rounds, so this is much cheaper to save than a snapshot
+  struct TurnState {
+    TurnState() : factories(), pool(), whiteTileInPool(true) {}
+    std::vector<Factory> factories;
+    int pool[azool::NUMCOLORS];
+    bool whiteTileInPool;
+  };  // struct TurnState
+
   GameBoard(int nPlayers=2);
+  GameBoard(int nPlayers, unsigned int seed);  // reproducible deals
   friend std::ostream& operator<<(std::ostream& out, const GameBoard& board);
   bool validFactoryRequest(int factoryIdx, azool::TileColor color);
   bool takeTilesFromFactory(int factoryIdx, azool::TileColor color, int& numTiles);
@@ -23,6 +37,13 @@ public:
   void returnTilesToBag(int numTiles, azool::TileColor color);
   void dealTiles();
   int numFactories() { return tileFactories.size(); }
+  const std::vector<Factory>& getFactories() const { return tileFactories; }
+  int numInPool(azool::TileColor color) const { return pool[color]; }
+  // false if the state doesn't fit in (or can't have come from) a snapshot
+  bool saveSnapshot(azool::BoardSnapshot& snap) const;
+  bool loadSnapshot(const azool::BoardSnapshot& snap);
+  void saveTurnState(TurnState& state) const;
+  void restoreTurnState(const TurnState& state);
   bool endOfRound() {
     // round ends when the pool and tile factories are empty
     for (int ii = 0; ii < azool::NUMCOLORS; ++ii) {
@@ -0,0 +1,32 @@
+#ifndef MOVE_H_
+#define MOVE_H_
+#include <string>
+#include "tile_utils.h"
+
+namespace azool {
+  // Compact, line-oriented notation for a single move. Factory and row
+  // numbers are 1-indexed, same as the interactive prompts:
+  //   f<factory><color><row>   take from factory,   e.g. "f3r2"
+  //   p<color><row>            take from pool,      e.g. "pk5"
+  //   df<factory><color>       discard from factory e.g. "df1y"
+  //   dp<color>                discard from pool    e.g. "dpg"
+  // Colors use TileColorSyms: [r|b|g|y|k]
+  struct Move {
+    enum Source {
+      FACTORY = 0,
+      POOL
+    };
+    Move() : source(FACTORY), factoryIdx(-1), color(NONE), rowIdx(-1) {}
+    Source source;
+    int factoryIdx;  // 0-indexed; -1 when taking from the pool
+    TileColor color;
+    int rowIdx;  // 0-indexed; -1 means discard to the floor
+    bool isDiscard() const { return rowIdx < 0; }
+  };  // struct Move
+
+  TileColor colorFromSym(char sym);
+  // returns false (and leaves move untouched) if the text isn't a valid move
+  bool parseMove(const std::string& text, Move& move);
+  std::string moveToString(const Move& move);
+}  // namespace azool
+#endif  // MOVE_H_
@@ -2,8 +2,13 @@
 #define PLAYER_H_
 #include "GameBoard.h"
 #include "tile_utils.h"
+#include "Move.h"
 #include <string>
 
+namespace azool {
+  struct PlayerSnapshot;
+}
+
 class Player {
 public:
   Player(GameBoard* const board, std::string name = "1");
@@ -12,6 +17,12 @@ public:
   bool takeTilesFromPool(azool::TileColor color, int rowIdx);
   bool discardFromFactory(int factoryIdx, azool::TileColor color);
   bool discardFromPool(azool::TileColor color);
+  bool applyMove(const azool::Move& move);
+  // fills moves with every legal move for the current board. If canonical,
+  // only one move per equivalence class is kept (see Player.cc), and
+  // multiplicity (if given) gets the size of each move's class
+  void legalMoves(std::vector<azool::Move>& moves, bool canonical = false,
+                  std::vector<int>* multiplicity = nullptr) const;
   void placeTiles(int rowIdx, azool::TileColor color, int numTiles);
   void endRound(bool& fullRow);
   void finalizeScore();
@@ -19,6 +30,8 @@ public:
   std::string printMyBoard() const;
   bool tookPenalty() const { return myTookPoolPenaltyThisRound; }
   const std::string getPlayerName() const { return myName; }
+  void saveSnapshot(azool::PlayerSnapshot& snap) const;
+  bool loadSnapshot(const azool::PlayerSnapshot& snap);  // false if snap is malformed
 
 private:
   Player(const Player&) = delete;
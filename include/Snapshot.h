@@ -0,0 +1,101 @@
+#ifndef SNAPSHOT_H_
+#define SNAPSHOT_H_
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "tile_utils.h"
+#include "Move.h"
+
+class GameBoard;
+class Player;
+
+namespace azool {
+  const int MAXPLAYERS = 4;
+  const int MAXFACTORIES = 2*MAXPLAYERS + 1;
+  const int MAXRESULTS = 256;
+  // most tiles of one color in any count loadSnapshot will accept; the bag
+  // starts with 20 of each, but returned tiles keep adding to it
+  const int MAXTILES = 1000;
+  const int MAXTILESPERFACTORY = 4;
+  const uint32_t SNAPSHOTMAGIC = 0x617a6f32;  // "azo2"
+
+  // Fixed-layout copies of the game state. Everything is plain integers so
+  // the structs can live in shared memory and be read in place by any
+  // process running the same binary.
+  struct BoardSnapshot {
+    int32_t numFactories;
+    int32_t factories[MAXFACTORIES][NUMCOLORS];
+    int32_t pool[NUMCOLORS];
+    int32_t bagCounts[NUMCOLORS];  // bag order isn't kept; it's reshuffled every deal
+    int32_t maxNumFactories;
+    uint8_t whiteTileInPool;
+    uint8_t lastRound;
+  };  // struct BoardSnapshot
+
+  struct PlayerSnapshot {
+    int32_t rowCounts[NUMCOLORS];
+    int32_t rowColors[NUMCOLORS];  // NONE for an empty row
+    uint8_t grid[NUMCOLORS][NUMCOLORS];
+    int32_t score;
+    int32_t numPenalties;
+    uint8_t tookPoolPenalty;
+  };  // struct PlayerSnapshot
+
+  // slot for a worker to post the value it computed for a move;
+  // posted is set last so readers never see a half-written slot
+  struct MoveResult {
+    MoveResult() : move(), value(0), posted(0) {}
+    Move move;
+    int64_t value;
+    std::atomic<int32_t> posted;
+  };  // struct MoveResult
+
+  struct SharedState {
+    SharedState() : magic(SNAPSHOTMAGIC), numPlayers(0), currentPlayer(0),
+                    board(), players(), numResults(0), results() {}
+    uint32_t magic;
+    int32_t numPlayers;
+    int32_t currentPlayer;
+    BoardSnapshot board;
+    PlayerSnapshot players[MAXPLAYERS];
+    std::atomic<int32_t> numResults;  // # of result slots claimed, never above MAXRESULTS
+    MoveResult results[MAXRESULTS];
+  };  // struct SharedState
+
+  // Copy a whole game (board, every player, whose turn it is) to or from a
+  // SharedState. Both return false for more than MAXPLAYERS players, a player
+  // count that doesn't match the state, or a snapshot that fails to load.
+  bool saveState(const GameBoard& board, const std::vector<Player*>& players,
+                 int currentPlayer, SharedState& state);
+  bool loadState(const SharedState& state, GameBoard& board,
+                 const std::vector<Player*>& players, int& currentPlayer);
+
+  // Maps a SharedState into a POSIX shared-memory segment. The process that
+  // calls create() owns the segment and unlinks it on destruction; workers
+  // call open() with the same name.
+  class SharedSnapshot {
+  public:
+    SharedSnapshot();
+    ~SharedSnapshot();
+    bool create(const std::string& name);
+    bool open(const std::string& name);
+    SharedState* state() const { return myState; }
+    // claims the next result slot; false if they're all taken
+    bool postResult(const Move& move, long long value);
+    // empties the result area so the segment can be reused for another
+    // position; only call while no worker is posting
+    void clearResults();
+
+  private:
+    SharedSnapshot(const SharedSnapshot&) = delete;
+    SharedSnapshot operator=(const SharedSnapshot&) = delete;
+    bool mapSegment(int fd);
+    void release();
+
+    SharedState* myState;
+    std::string myName;
+    bool myOwner;
+  };  // class SharedSnapshot
+}  // namespace azool
+#endif  // SNAPSHOT_H_
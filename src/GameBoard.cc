@@ -1,16 +1,21 @@
 #include "GameBoard.h"
+#include "Snapshot.h"
 #include <algorithm>
 #include <chrono>
 
 GameBoard::GameBoard(int numPlayers) :
+  GameBoard(numPlayers,
+            std::chrono::system_clock::now().time_since_epoch().count()) {
+  }  // GameBoard::GameBoard
+
+GameBoard::GameBoard(int numPlayers, unsigned int seed) :
   tileFactories(),
   maxNumFactories(numPlayers*2+1),
   pool(),
   whiteTileInPool(true),
   tileBag(),
   lastRound(false),
-  rng(std::default_random_engine(
-         std::chrono::system_clock::now().time_since_epoch().count())) {
+  rng(seed) {
     resetBoard();
   }  // GameBoard::GameBoard
 
@@ -114,3 +119,75 @@ void GameBoard::resetBoard() {
   }
   whiteTileInPool = true;
 }   // GameBoard::resetBoard
+
+bool GameBoard::saveSnapshot(azool::BoardSnapshot& snap) const {
+  // boards for more than MAXPLAYERS players deal too many factories to fit
+  if (maxNumFactories > azool::MAXFACTORIES or
+      tileFactories.size() > azool::MAXFACTORIES) {
+    return false;
+  }
+  snap.numFactories = tileFactories.size();
+  for (int ii = 0; ii < snap.numFactories; ++ii) {
+    for (int jj = 0; jj < azool::NUMCOLORS; ++jj) {
+      snap.factories[ii][jj] = tileFactories[ii].tileCounts[jj];
+    }
+  }
+  for (int ii = 0; ii < azool::NUMCOLORS; ++ii) {
+    snap.pool[ii] = pool[ii];
+    snap.bagCounts[ii] = 0;
+  }
+  for (auto tile : tileBag) {
+    snap.bagCounts[tile]++;
+  }
+  snap.maxNumFactories = maxNumFactories;
+  snap.whiteTileInPool = whiteTileInPool;
+  snap.lastRound = lastRound;
+  return true;
+}  // GameBoard::saveSnapshot
+
+bool GameBoard::loadSnapshot(const azool::BoardSnapshot& snap) {
+  // snapshots may come from memory we don't control; check before indexing
+  if (snap.numFactories < 0 or snap.numFactories > azool::MAXFACTORIES or
+      snap.maxNumFactories < 0 or snap.maxNumFactories > azool::MAXFACTORIES) {
+    return false;
+  }
+  for (int ii = 0; ii < azool::NUMCOLORS; ++ii) {
+    if (snap.pool[ii] < 0 or snap.pool[ii] > azool::MAXTILES or
+        snap.bagCounts[ii] < 0 or snap.bagCounts[ii] > azool::MAXTILES) {
+      return false;
+    }
+    for (int jj = 0; jj < snap.numFactories; ++jj) {
+      if (snap.factories[jj][ii] < 0 or
+          snap.factories[jj][ii] > azool::MAXTILESPERFACTORY) {
+        return false;
+      }
+    }
+  }
+  tileFactories.resize(snap.numFactories);
+  for (int ii = 0; ii < snap.numFactories; ++ii) {
+    memcpy(tileFactories[ii].tileCounts, snap.factories[ii],
+           azool::NUMCOLORS*sizeof(int));
+  }
+  memcpy(pool, snap.pool, azool::NUMCOLORS*sizeof(int));
+  tileBag.clear();
+  for (int ii = 0; ii < azool::NUMCOLORS; ++ii) {
+    tileBag.insert(tileBag.end(), snap.bagCounts[ii],
+                   static_cast<azool::TileColor>(ii));
+  }
+  maxNumFactories = snap.maxNumFactories;
+  whiteTileInPool = snap.whiteTileInPool;
+  lastRound = snap.lastRound;
+  return true;
+}  // GameBoard::loadSnapshot
+
+void GameBoard::saveTurnState(TurnState& state) const {
+  state.factories = tileFactories;
+  memcpy(state.pool, pool, azool::NUMCOLORS*sizeof(int));
+  state.whiteTileInPool = whiteTileInPool;
+}  // GameBoard::saveTurnState
+
+void GameBoard::restoreTurnState(const TurnState& state) {
+  tileFactories = state.factories;
+  memcpy(pool, state.pool, azool::NUMCOLORS*sizeof(int));
+  whiteTileInPool = state.whiteTileInPool;
+}  // GameBoard::restoreTurnState
@@ -0,0 +1,78 @@
+#include "Move.h"
+
+namespace {
+  // no factory or row number is anywhere near this big
+  const int MAXNUMBER = 99;
+
+  // reads a positive decimal number starting at pos; advances pos past it.
+  // returns -1 if there's no number or it's larger than MAXNUMBER
+  int readNumber(const std::string& text, size_t& pos) {
+    int value = 0;
+    size_t start = pos;
+    while (pos < text.size() and text[pos] >= '0' and text[pos] <= '9') {
+      value = value*10 + (text[pos] - '0');
+      pos++;
+      if (value > MAXNUMBER) return -1;
+    }
+    return pos == start ? -1 : value;
+  }
+}  // anonymous namespace
+
+azool::TileColor azool::colorFromSym(char sym) {
+  for (int ii = 0; ii < NUMCOLORS; ++ii) {
+    if (TileColorSyms[ii] == sym) {
+      return static_cast<TileColor>(ii);
+    }
+  }
+  return NONE;
+}  // azool::colorFromSym
+
+bool azool::parseMove(const std::string& text, Move& move) {
+  Move parsed;
+  size_t pos = 0;
+  if (text.empty()) return false;
+  bool discard = (text[pos] == 'd');
+  if (discard) pos++;
+  if (pos >= text.size()) return false;
+  char source = text[pos++];
+  if (source == 'f') {
+    parsed.source = Move::FACTORY;
+    int factIdx = readNumber(text, pos);
+    if (factIdx < 1) return false;
+    parsed.factoryIdx = factIdx - 1;
+  }
+  else if (source == 'p') {
+    parsed.source = Move::POOL;
+  }
+  else {
+    return false;
+  }
+  if (pos >= text.size()) return false;
+  parsed.color = colorFromSym(text[pos++]);
+  if (parsed.color == NONE) return false;
+  if (!discard) {
+    int rowIdx = readNumber(text, pos);
+    if (rowIdx < 1 or rowIdx > NUMCOLORS) return false;
+    parsed.rowIdx = rowIdx - 1;
+  }
+  if (pos != text.size()) return false;  // trailing garbage
+  move = parsed;
+  return true;
+}  // azool::parseMove
+
+std::string azool::moveToString(const Move& move) {
+  std::string out;
+  if (move.isDiscard()) out += 'd';
+  if (move.source == Move::FACTORY) {
+    out += 'f';
+    out += std::to_string(move.factoryIdx + 1);
+  }
+  else {
+    out += 'p';
+  }
+  out += TileColorSyms[move.color];
+  if (!move.isDiscard()) {
+    out += static_cast<char>('1' + move.rowIdx);
+  }
+  return out;
+}  // azool::moveToString
@@ -1,4 +1,5 @@
 #include "Player.h"
+#include "Snapshot.h"
 #include <iostream>
 #include <cstring>
 #include <sstream>
@@ -287,6 +288,7 @@ bool Player::discardFromPool(azool::TileColor color) {
   int numTiles = -1;
   if (myBoardPtr->takeTilesFromPool(color, numTiles, poolPenalty)) {
     if (poolPenalty) {
+      myTookPoolPenaltyThisRound = true;
       myNumPenaltiesForRound++;
     }
     myNumPenaltiesForRound += numTiles;
@@ -295,13 +297,123 @@ bool Player::discardFromPool(azool::TileColor color) {
   return false;
 }  // Player::discardFromPool
 
+bool Player::applyMove(const azool::Move& move) {
+  if (move.source == azool::Move::FACTORY) {
+    if (move.isDiscard()) {
+      return discardFromFactory(move.factoryIdx, move.color);
+    }
+    return takeTilesFromFactory(move.factoryIdx, move.color, move.rowIdx);
+  }
+  if (move.isDiscard()) {
+    return discardFromPool(move.color);
+  }
+  return takeTilesFromPool(move.color, move.rowIdx);
+}  // Player::applyMove
+
+// Canonical moves drop two kinds of duplicates:
+//  - factories with identical tileCounts leave the same board behind when the
+//    same color is taken, so only the first such factory is used
+//  - placing onto a row that's already full of that color sends every tile
+//    to the floor, which is exactly a discard
+void Player::legalMoves(std::vector<azool::Move>& moves, bool canonical,
+                        std::vector<int>* multiplicity) const {
+  moves.clear();
+  if (multiplicity) multiplicity->clear();
+  const std::vector<GameBoard::Factory>& factories = myBoardPtr->getFactories();
+  int numSources = factories.size() + 1;  // every factory, then the pool
+  for (int srcIdx = 0; srcIdx < numSources; ++srcIdx) {
+    bool fromPool = (srcIdx == numSources - 1);
+    int numCopies = 1;
+    if (!fromPool and canonical) {
+      bool seenBefore = false;
+      for (int ii = 0; ii < factories.size(); ++ii) {
+        if (memcmp(factories[ii].tileCounts, factories[srcIdx].tileCounts,
+                   azool::NUMCOLORS*sizeof(int)) != 0) {
+          continue;
+        }
+        if (ii < srcIdx) {
+          seenBefore = true;
+          break;
+        }
+        if (ii > srcIdx) numCopies++;
+      }
+      if (seenBefore) continue;
+    }
+    azool::Move move;
+    move.source = fromPool ? azool::Move::POOL : azool::Move::FACTORY;
+    move.factoryIdx = fromPool ? -1 : srcIdx;
+    for (int color = 0; color < azool::NUMCOLORS; ++color) {
+      int numTiles = fromPool ? myBoardPtr->numInPool(static_cast<azool::TileColor>(color))
+                              : factories[srcIdx].tileCounts[color];
+      if (numTiles == 0) continue;
+      move.color = static_cast<azool::TileColor>(color);
+      int numDiscardCopies = numCopies;
+      for (int rowIdx = 0; rowIdx < azool::NUMCOLORS; ++rowIdx) {
+        if (!checkValidMove(move.color, rowIdx)) continue;
+        if (canonical and myRows[rowIdx].first == rowIdx + 1) {
+          numDiscardCopies += numCopies;  // full row, same as discarding
+          continue;
+        }
+        move.rowIdx = rowIdx;
+        moves.push_back(move);
+        if (multiplicity) multiplicity->push_back(numCopies);
+      }
+      move.rowIdx = -1;
+      moves.push_back(move);
+      if (multiplicity) multiplicity->push_back(numDiscardCopies);
+    }  // iterate over colors
+  }  // iterate over factories and pool
+}  // Player::legalMoves
+
+void Player::saveSnapshot(azool::PlayerSnapshot& snap) const {
+  for (int ii = 0; ii < azool::NUMCOLORS; ++ii) {
+    snap.rowCounts[ii] = myRows[ii].first;
+    snap.rowColors[ii] = myRows[ii].second;
+    for (int jj = 0; jj < azool::NUMCOLORS; ++jj) {
+      snap.grid[ii][jj] = myGrid[ii][jj];
+    }
+  }
+  snap.score = myScore;
+  snap.numPenalties = myNumPenaltiesForRound;
+  snap.tookPoolPenalty = myTookPoolPenaltyThisRound;
+}  // Player::saveSnapshot
+
+bool Player::loadSnapshot(const azool::PlayerSnapshot& snap) {
+  for (int ii = 0; ii < azool::NUMCOLORS; ++ii) {
+    int color = snap.rowColors[ii];
+    if (snap.rowCounts[ii] < 0 or snap.rowCounts[ii] > ii + 1 or
+        color < azool::NONE or color >= azool::NUMCOLORS) {
+      return false;
+    }
+    // a row holds tiles exactly when it has a color, and never a color
+    // that's already on that row of the grid
+    if ((snap.rowCounts[ii] > 0) != (color != azool::NONE)) {
+      return false;
+    }
+    if (color != azool::NONE and snap.grid[ii][(5 + color - ii) % 5]) {
+      return false;
+    }
+  }
+  for (int ii = 0; ii < azool::NUMCOLORS; ++ii) {
+    myRows[ii].first = snap.rowCounts[ii];
+    myRows[ii].second = static_cast<azool::TileColor>(snap.rowColors[ii]);
+    for (int jj = 0; jj < azool::NUMCOLORS; ++jj) {
+      myGrid[ii][jj] = snap.grid[ii][jj];
+    }
+  }
+  myScore = snap.score;
+  myNumPenaltiesForRound = snap.numPenalties;
+  myTookPoolPenaltyThisRound = snap.tookPoolPenalty;
+  return true;
+}  // Player::loadSnapshot
+
 namespace {
   int promptForFactoryIdx(int maxNumFactories) {
     static const char* promptFactoryIdxDraw = "Which factory? enter index\n";
-    char factInput;  // TODO can we safely say there will never be more than 9 possible?
+    char factInput = '\0';  // TODO can we safely say there will never be more than 9 possible?
     std::cout << promptFactoryIdxDraw << std::flush;
     std::cin >> factInput;
-    int factIdx = std::atoi(&factInput);
+    int factIdx = factInput - '0';
     if (factIdx < 1 or factIdx > maxNumFactories) {
       return -1;
     }
@@ -312,33 +424,14 @@ namespace {
     char colorInput = '\0';
     std::cout << promptColorDraw << std::flush;
     std::cin >> colorInput;
-    switch(colorInput) {
-      case 'r':
-        return azool::RED;
-        break;
-      case 'b':
-        return azool::BLUE;
-        break;
-      case 'g':
-        return azool::GREEN;
-        break;
-      case 'y':
-        return azool::YELLOW;
-        break;
-      case 'k':
-        return azool::BLACK;
-        break;
-      default:
-        return azool::NONE;
-    }  // end switch
-    return azool::NONE;
+    return azool::colorFromSym(colorInput);
   }
   int promptForRow() {
     static const char* promptRowPlacement = "Place on which row? enter number [1-5]\n";
-    char rowInput;
+    char rowInput = '\0';
     std::cout << promptRowPlacement << std::flush;
     std::cin >> rowInput;
-    int rowIdx = std::atoi(&rowInput);
+    int rowIdx = rowInput - '0';
     if (rowIdx < 1 or rowIdx > azool::NUMCOLORS) {
       return -1;
     }
@@ -0,0 +1,149 @@
+#include "Snapshot.h"
+#include "GameBoard.h"
+#include "Player.h"
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <iostream>
+#include <new>
+#include <type_traits>
+
+static_assert(std::is_trivially_copyable<azool::BoardSnapshot>::value,
+              "BoardSnapshot must be readable in place from shared memory");
+static_assert(std::is_trivially_copyable<azool::PlayerSnapshot>::value,
+              "PlayerSnapshot must be readable in place from shared memory");
+static_assert(std::is_standard_layout<azool::SharedState>::value,
+              "SharedState layout must be identical across processes");
+static_assert(ATOMIC_INT_LOCK_FREE == 2,
+              "result slots need lock-free atomics to work across processes");
+
+bool azool::saveState(const GameBoard& board, const std::vector<Player*>& players,
+                      int currentPlayer, SharedState& state) {
+  if (players.size() > MAXPLAYERS or currentPlayer < 0 or
+      currentPlayer >= players.size() or !board.saveSnapshot(state.board)) {
+    return false;
+  }
+  for (int ii = 0; ii < players.size(); ++ii) {
+    players[ii]->saveSnapshot(state.players[ii]);
+  }
+  state.numPlayers = players.size();
+  state.currentPlayer = currentPlayer;
+  return true;
+}  // azool::saveState
+
+bool azool::loadState(const SharedState& state, GameBoard& board,
+                      const std::vector<Player*>& players, int& currentPlayer) {
+  if (state.numPlayers < 0 or state.numPlayers > MAXPLAYERS or
+      state.numPlayers != players.size() or
+      state.currentPlayer < 0 or state.currentPlayer >= state.numPlayers or
+      !board.loadSnapshot(state.board)) {
+    return false;
+  }
+  for (int ii = 0; ii < players.size(); ++ii) {
+    if (!players[ii]->loadSnapshot(state.players[ii])) {
+      return false;
+    }
+  }
+  currentPlayer = state.currentPlayer;
+  return true;
+}  // azool::loadState
+
+azool::SharedSnapshot::SharedSnapshot() :
+  myState(nullptr),
+  myName(),
+  myOwner(false) {
+  }  // SharedSnapshot::SharedSnapshot
+
+azool::SharedSnapshot::~SharedSnapshot() {
+  release();
+}  // SharedSnapshot::~SharedSnapshot
+
+bool azool::SharedSnapshot::create(const std::string& name) {
+  release();
+  int fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+  if (fd < 0) {
+    std::cerr << "Couldn't create shared memory segment " << name << std::endl;
+    return false;
+  }
+  if (ftruncate(fd, sizeof(SharedState)) != 0) {
+    std::cerr << "Couldn't size shared memory segment " << name << std::endl;
+    close(fd);
+    shm_unlink(name.c_str());
+    return false;
+  }
+  myName = name;
+  myOwner = true;
+  if (!mapSegment(fd)) {
+    release();
+    return false;
+  }
+  new (myState) SharedState();
+  return true;
+}  // SharedSnapshot::create
+
+bool azool::SharedSnapshot::open(const std::string& name) {
+  release();
+  int fd = shm_open(name.c_str(), O_RDWR, 0600);
+  if (fd < 0) {
+    std::cerr << "Couldn't open shared memory segment " << name << std::endl;
+    return false;
+  }
+  myName = name;
+  if (!mapSegment(fd)) {
+    return false;
+  }
+  if (myState->magic != SNAPSHOTMAGIC) {
+    std::cerr << "Shared memory segment " << name
+              << " doesn't hold a game snapshot" << std::endl;
+    release();
+    return false;
+  }
+  return true;
+}  // SharedSnapshot::open
+
+bool azool::SharedSnapshot::postResult(const Move& move, long long value) {
+  // only claim a slot while there's one left, so numResults never
+  // points past the end of results
+  int32_t slot = myState->numResults.load();
+  do {
+    if (slot >= MAXRESULTS) {
+      return false;
+    }
+  } while (!myState->numResults.compare_exchange_weak(slot, slot + 1));
+  myState->results[slot].move = move;
+  myState->results[slot].value = value;
+  myState->results[slot].posted.store(1, std::memory_order_release);
+  return true;
+}  // SharedSnapshot::postResult
+
+void azool::SharedSnapshot::clearResults() {
+  for (int ii = 0; ii < MAXRESULTS; ++ii) {
+    myState->results[ii].posted.store(0);
+  }
+  myState->numResults.store(0);
+}  // SharedSnapshot::clearResults
+
+bool azool::SharedSnapshot::mapSegment(int fd) {
+  void* addr = mmap(nullptr, sizeof(SharedState), PROT_READ | PROT_WRITE,
+                    MAP_SHARED, fd, 0);
+  close(fd);  // the mapping stays valid after closing
+  if (addr == MAP_FAILED) {
+    std::cerr << "Couldn't map shared memory segment " << myName << std::endl;
+    return false;
+  }
+  myState = static_cast<SharedState*>(addr);
+  return true;
+}  // SharedSnapshot::mapSegment
+
+void azool::SharedSnapshot::release() {
+  if (myState) {
+    munmap(myState, sizeof(SharedState));
+    myState = nullptr;
+  }
+  if (myOwner) {
+    shm_unlink(myName.c_str());
+    myOwner = false;
+  }
+  myName.clear();
+}  // SharedSnapshot::release
@@ -1,6 +1,11 @@
 #include "GameBoard.h"
 #include "Player.h"
+#include "Move.h"
+#include <cerrno>
+#include <cstdlib>
 #include <iostream>
+#include <limits>
+#include <string>
 
 // who manages turns and rounds? probably the main function
 
@@ -54,7 +59,114 @@ void playGame(GameBoard* game) {
   }
 }
 
-int main() {
+namespace {
+  // Batch protocol, one block per game on stdin:
+  //   game <seed>
+  //   <move>   (one per line, notation in Move.h; P1 and P2 alternate)
+  //   end
+  // One line per game is written to stdout:
+  //   <seed> <ok|incomplete|invalid> <# moves applied> <P1 score> <P2 score> [bad move]
+  // A header whose seed doesn't parse gets an invalid line with "-" for the
+  // seed, and its block is skipped. Lines may end in CRLF.
+  // getline that also drops the '\r' of a CRLF line ending
+  bool readLine(std::istream& in, std::string& line) {
+    if (!std::getline(in, line)) return false;
+    if (!line.empty() and line.back() == '\r') line.pop_back();
+    return true;
+  }
+
+  std::string playBatchGame(unsigned int seed, std::istream& in) {
+    GameBoard game(2, seed);
+    Player p1(&game, "P1");
+    Player p2(&game, "P2");
+    Player* players[2] = {&p1, &p2};
+    int current = 0;
+    int numApplied = 0;
+    bool endOfGame = false;
+    std::string badMove;
+    std::string line;
+    game.dealTiles();
+    while (readLine(in, line) and line != "end") {
+      if (line.empty() or !badMove.empty()) continue;
+      azool::Move move;
+      if (endOfGame or !azool::parseMove(line, move) or
+          !players[current]->applyMove(move)) {
+        badMove = line;
+        continue;
+      }
+      numApplied++;
+      current = 1 - current;
+      if (!game.endOfRound()) continue;
+      // whoever took the pool penalty goes first next round;
+      // needs to be checked before calling endRound()
+      current = players[1]->tookPenalty() ? 1 : 0;
+      bool p0EndsGame = false;
+      bool p1EndsGame = false;
+      players[0]->endRound(p0EndsGame);
+      players[1]->endRound(p1EndsGame);
+      endOfGame = p0EndsGame or p1EndsGame;
+      if (endOfGame) {
+        players[0]->finalizeScore();
+        players[1]->finalizeScore();
+      }
+      else {
+        game.dealTiles();
+      }
+    }
+    std::string result = std::to_string(seed);
+    if (!badMove.empty()) result += " invalid ";
+    else if (endOfGame) result += " ok ";
+    else result += " incomplete ";
+    result += std::to_string(numApplied) + " " +
+              std::to_string(players[0]->getScore()) + " " +
+              std::to_string(players[1]->getScore());
+    if (!badMove.empty()) result += " " + badMove;
+    result += "\n";
+    return result;
+  }
+
+  bool parseSeed(const std::string& text, unsigned int& seed) {
+    if (text.empty() or text[0] < '0' or text[0] > '9') return false;
+    errno = 0;
+    char* end = nullptr;
+    unsigned long value = std::strtoul(text.c_str(), &end, 10);
+    if (*end != '\0' or errno == ERANGE or
+        value > std::numeric_limits<unsigned int>::max()) {
+      return false;
+    }
+    seed = value;
+    return true;
+  }
+
+  void runBatch(std::istream& in, std::ostream& out) {
+    std::string line;
+    while (readLine(in, line)) {
+      if (line.compare(0, 5, "game ") != 0) continue;  // skip anything between games
+      std::string seedText = line.substr(5);
+      unsigned int seed = 0;
+      std::string result;
+      if (parseSeed(seedText, seed)) {
+        result = playBatchGame(seed, in);
+      }
+      else {
+        // bad header; report it and skip the rest of the block
+        result = "- invalid 0 0 0\n";
+        while (readLine(in, line) and line != "end") {}
+      }
+      out.write(result.data(), result.size());
+    }
+    out.flush();
+  }
+}  // anonymous namespace
+
+int main(int argc, char** argv) {
+  if (argc > 1 and std::string(argv[1]) == "--batch") {
+    // don't sync with C stdio or flush cout before every read
+    std::ios_base::sync_with_stdio(false);
+    std::cin.tie(nullptr);
+    runBatch(std::cin, std::cout);
+    return 0;
+  }
   GameBoard* game = new GameBoard();
   playGame(game);
   if (game) delete game;
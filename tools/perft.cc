@@ -0,0 +1,318 @@
+#include "GameBoard.h"
+#include "Player.h"
+#include "Snapshot.h"
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Counts every legal move sequence of a given length from a seeded deal.
+// usage: perft <depth> [seed] [threads] [--canonical] [--processes]
+//              [--expect <leaves>]
+// Like chess perft, leaves are positions exactly <depth> moves in; a line
+// that ends the round early stops there and isn't counted. With --canonical
+// only one move per equivalence class is searched and its subtree is weighted
+// by the class size, so the leaf count must match the full search.
+// With --processes the root split runs in <threads> forked worker processes
+// that read the position from a shared-memory segment and post their counts
+// back through its result area, instead of in threads.
+// With --expect the tool exits non-zero unless the leaf count matches.
+//
+// Known counts ("make perft-check" runs these). Deals come from
+// std::default_random_engine and std::shuffle, so they're only valid for
+// libstdc++ builds.
+//   seed  depth  leaves
+//   7     1      84
+//   7     2      6552
+//   7     3      397680
+//   7     4      20602400
+//   5     3      492132
+//   5     4      27115292
+
+namespace {
+  const int NUMPLAYERS = 2;
+
+  struct SearchStats {
+    SearchStats() : leaves(0), nodes(0) {}
+    long long leaves;  // weighted by move multiplicity
+    long long nodes;   // moves actually applied
+  };
+
+  // one independent copy of the game per thread
+  class Position {
+  public:
+    Position(unsigned int seed, const azool::SharedState& root) :
+      myBoard(NUMPLAYERS, seed),
+      myP1(&myBoard, "P1"),
+      myP2(&myBoard, "P2"),
+      myPlayers{&myP1, &myP2} {
+        reset(root);
+      }
+    void reset(const azool::SharedState& root) {
+      int current = 0;
+      if (!azool::loadState(root, myBoard, myPlayers, current)) {
+        std::cerr << "Couldn't load the root position" << std::endl;
+        std::abort();
+      }
+    }
+    void search(int depth, int current, bool canonical, SearchStats& stats) {
+      if (depth == 0) {
+        stats.leaves++;
+        return;
+      }
+      if (myBoard.endOfRound()) return;
+      std::vector<azool::Move> moves;
+      std::vector<int> multiplicity;
+      myPlayers[current]->legalMoves(moves, canonical, &multiplicity);
+      // a move only changes the factories, pool and the player moving,
+      // so only those get restored
+      GameBoard::TurnState boardState;
+      azool::PlayerSnapshot playerSnap;
+      myBoard.saveTurnState(boardState);
+      myPlayers[current]->saveSnapshot(playerSnap);
+      for (int ii = 0; ii < moves.size(); ++ii) {
+        SearchStats childStats;
+        applyMove(moves[ii], current);
+        search(depth - 1, 1 - current, canonical, childStats);
+        stats.leaves += childStats.leaves * multiplicity[ii];
+        stats.nodes += childStats.nodes + 1;
+        myBoard.restoreTurnState(boardState);
+        myPlayers[current]->loadSnapshot(playerSnap);
+      }
+    }
+    void applyMove(const azool::Move& move, int current) {
+      if (!myPlayers[current]->applyMove(move)) {
+        std::cerr << "Generated an illegal move: "
+                  << azool::moveToString(move) << std::endl;
+        std::abort();
+      }
+    }
+    void legalMoves(int current, std::vector<azool::Move>& moves,
+                    bool canonical, std::vector<int>& multiplicity) const {
+      myPlayers[current]->legalMoves(moves, canonical, &multiplicity);
+    }
+
+  private:
+    Position(const Position&) = delete;
+    Position operator=(const Position&) = delete;
+
+    GameBoard myBoard;
+    Player myP1;
+    Player myP2;
+    std::vector<Player*> myPlayers;
+  };  // class Position
+
+  // parses a whole non-negative decimal argument no bigger than max
+  bool parseArg(const char* text, unsigned long long max, unsigned long long& value) {
+    if (text[0] < '0' or text[0] > '9') return false;
+    errno = 0;
+    char* end = nullptr;
+    value = std::strtoull(text, &end, 10);
+    return *end == '\0' and errno != ERANGE and value <= max;
+  }
+
+  int usage(const char* prog) {
+    std::cerr << "usage: " << prog
+              << " <depth> [seed] [threads] [--canonical] [--processes] [--expect <leaves>]\n";
+    return 1;
+  }
+
+  // A worker posts one result per root move with its leaf count, then one
+  // with a default Move (factoryIdx -1, color NONE) holding its node count.
+  bool searchInProcesses(unsigned int seed, const azool::SharedState& root,
+                         const std::vector<azool::Move>& rootMoves,
+                         int depth, bool canonical, int numProcs,
+                         std::vector<SearchStats>& rootStats) {
+    if (rootMoves.size() + numProcs > azool::MAXRESULTS) {
+      std::cerr << "Too many root moves or processes for the result area\n";
+      return false;
+    }
+    std::string name = "/azool_perft_" + std::to_string(getpid());
+    azool::SharedSnapshot segment;
+    if (!segment.create(name)) return false;
+    azool::SharedState& shared = *segment.state();
+    shared.board = root.board;
+    for (int ii = 0; ii < root.numPlayers; ++ii) {
+      shared.players[ii] = root.players[ii];
+    }
+    shared.numPlayers = root.numPlayers;
+    shared.currentPlayer = root.currentPlayer;
+    segment.clearResults();
+    std::cout << std::flush;  // don't let the children inherit buffered output
+
+    std::vector<pid_t> children;
+    for (int proc = 0; proc < numProcs; ++proc) {
+      pid_t pid = fork();
+      if (pid < 0) {
+        std::cerr << "fork failed\n";
+        break;
+      }
+      if (pid == 0) {
+        azool::SharedSnapshot worker;
+        if (!worker.open(name)) _exit(1);
+        Position pos(seed, *worker.state());
+        long long nodes = 0;
+        for (int ii = proc; ii < rootMoves.size(); ii += numProcs) {
+          SearchStats stats;
+          pos.applyMove(rootMoves[ii], 0);
+          pos.search(depth - 1, 1, canonical, stats);
+          nodes += stats.nodes + 1;
+          pos.reset(*worker.state());
+          if (!worker.postResult(rootMoves[ii], stats.leaves)) _exit(1);
+        }
+        _exit(worker.postResult(azool::Move(), nodes) ? 0 : 1);
+      }
+      children.push_back(pid);
+    }
+    bool allOk = children.size() == numProcs;
+    for (auto pid : children) {
+      int status = 0;
+      waitpid(pid, &status, 0);
+      allOk = allOk and WIFEXITED(status) and WEXITSTATUS(status) == 0;
+    }
+    if (!allOk) {
+      std::cerr << "A worker process failed\n";
+      return false;
+    }
+
+    // node totals don't belong to any one root move; keep them on the first
+    int numPosted = shared.numResults.load();
+    for (int slot = 0; slot < numPosted; ++slot) {
+      const azool::MoveResult& result = shared.results[slot];
+      if (!result.posted.load(std::memory_order_acquire)) return false;
+      if (result.move.color == azool::NONE) {
+        rootStats[0].nodes += result.value;
+        continue;
+      }
+      std::string moveText = azool::moveToString(result.move);
+      for (int ii = 0; ii < rootMoves.size(); ++ii) {
+        if (azool::moveToString(rootMoves[ii]) == moveText) {
+          rootStats[ii].leaves = result.value;
+          break;
+        }
+      }
+    }
+    return numPosted == rootMoves.size() + numProcs;
+  }  // searchInProcesses
+}  // anonymous namespace
+
+int main(int argc, char** argv) {
+  bool canonical = false;
+  bool useProcesses = false;
+  long long expected = -1;
+  std::vector<const char*> args;
+  for (int ii = 1; ii < argc; ++ii) {
+    if (strcmp(argv[ii], "--canonical") == 0) {
+      canonical = true;
+    }
+    else if (strcmp(argv[ii], "--processes") == 0) {
+      useProcesses = true;
+    }
+    else if (strcmp(argv[ii], "--expect") == 0) {
+      unsigned long long value = 0;
+      if (ii + 1 >= argc or
+          !parseArg(argv[++ii], std::numeric_limits<long long>::max(), value)) {
+        return usage(argv[0]);
+      }
+      expected = value;
+    }
+    else {
+      args.push_back(argv[ii]);
+    }
+  }
+  if (args.empty() or args.size() > 3) {
+    return usage(argv[0]);
+  }
+  unsigned long long depthArg = 0;
+  unsigned long long seedArg = 0;
+  unsigned long long threadsArg = std::thread::hardware_concurrency();
+  if (!parseArg(args[0], 100, depthArg) or depthArg < 1 or
+      (args.size() > 1 and
+       !parseArg(args[1], std::numeric_limits<unsigned int>::max(), seedArg)) or
+      (args.size() > 2 and !parseArg(args[2], 1024, threadsArg))) {
+    return usage(argv[0]);
+  }
+  int depth = depthArg;
+  unsigned int seed = seedArg;
+  int numThreads = threadsArg < 1 ? 1 : threadsArg;
+
+  // deal from the seed and keep a snapshot every thread starts from
+  azool::SharedState root;
+  {
+    GameBoard board(NUMPLAYERS, seed);
+    Player p1(&board, "P1");
+    Player p2(&board, "P2");
+    board.dealTiles();
+    azool::saveState(board, {&p1, &p2}, 0, root);
+    std::cout << p1.printMyBoard();
+  }
+  std::vector<azool::Move> rootMoves;
+  std::vector<int> rootMultiplicity;
+  {
+    Position pos(seed, root);
+    pos.legalMoves(0, rootMoves, canonical, rootMultiplicity);
+  }
+
+  // split at the root: threads pull root moves off a shared counter
+  std::vector<SearchStats> rootStats(rootMoves.size());
+  std::atomic<int> nextMove(0);
+  auto worker = [&]() {
+    Position pos(seed, root);
+    for (int ii = nextMove++; ii < rootMoves.size(); ii = nextMove++) {
+      pos.applyMove(rootMoves[ii], 0);
+      pos.search(depth - 1, 1, canonical, rootStats[ii]);
+      rootStats[ii].nodes++;
+      pos.reset(root);
+    }
+  };
+  auto start = std::chrono::steady_clock::now();
+  if (useProcesses) {
+    if (!searchInProcesses(seed, root, rootMoves, depth, canonical,
+                           numThreads, rootStats)) {
+      return 1;
+    }
+  }
+  else {
+    std::vector<std::thread> threads;
+    for (int ii = 0; ii < numThreads; ++ii) {
+      threads.emplace_back(worker);
+    }
+    for (auto& thread : threads) {
+      thread.join();
+    }
+  }
+  double seconds = std::chrono::duration<double>(
+      std::chrono::steady_clock::now() - start).count();
+
+  SearchStats total;
+  for (int ii = 0; ii < rootMoves.size(); ++ii) {
+    std::cout << azool::moveToString(rootMoves[ii]);
+    if (canonical) std::cout << " x" << rootMultiplicity[ii];
+    std::cout << ": " << rootStats[ii].leaves << "\n";
+    total.leaves += rootStats[ii].leaves * rootMultiplicity[ii];
+    total.nodes += rootStats[ii].nodes;
+  }
+  std::cout << "\nDepth " << depth << ", seed " << seed << ", "
+            << numThreads << (useProcesses ? " process(es)" : " thread(s)")
+            << (canonical ? ", canonical" : "") << "\n"
+            << "Leaves: " << total.leaves << "\n"
+            << "Nodes: " << total.nodes << "\n"
+            << "Time: " << seconds << "s\n"
+            << "Nodes/sec: "
+            << (seconds > 0 ? static_cast<long long>(total.nodes / seconds) : 0) << "\n"
+            << std::flush;
+  if (expected >= 0 and total.leaves != expected) {
+    std::cerr << "MISMATCH: expected " << expected << " leaves, got "
+              << total.leaves << std::endl;
+    return 1;
+  }
+  return 0;
+}